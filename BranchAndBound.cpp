@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2020 Samuel Prevost.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "BranchAndBound.h"
+
+// Distance to the closest integer under which a value is considered integral
+#define INTEGRALITY_TOL 1e-6
+// Nodes whose bound is not better than the incumbent by at least this much are pruned
+#define PRUNE_TOL 1e-9
+
+using namespace Simplex;
+
+namespace BranchAndBound {
+
+    double Result::nodes_per_sec() const {
+        return (seconds > 0) ? nodes / seconds : 0;
+    }
+
+    Problem* get_node_problem(const Problem* root, const vector<BranchBound>& bounds, const VectorXi& basic_vars) {
+        long rows = root->A.rows(), cols = root->A.cols();
+        long count = bounds.size();
+
+        MatrixXd A = MatrixXd::Zero(rows + count, cols + count);
+        A.topLeftCorner(rows, cols) = root->A;
+        VectorXd b(rows + count);
+        b.head(rows) = root->b;
+        VectorXd costs = VectorXd::Zero(cols + count);
+        costs.head(cols) = root->costs;
+
+        // x_var <= value becomes  x_var + s = value
+        // x_var >= value becomes -x_var + s = -value
+        for (int k = 0; k < count; ++k) {
+            double sign = bounds[k].is_upper ? 1 : -1;
+            A(rows + k, bounds[k].var) = sign;
+            A(rows + k, cols + k) = 1;
+            b(rows + k) = sign * bounds[k].value;
+        }
+
+        // The slacks of the rows the given base doesn't know about yet enter it
+        VectorXi node_basic_vars(rows + count);
+        node_basic_vars.head(basic_vars.size()) = basic_vars;
+        for (long k = basic_vars.size() - rows; k < count; ++k) {
+            node_basic_vars(rows + k) = cols + k;
+        }
+
+        auto* problem = new Problem(A, b, costs, node_basic_vars);
+        problem->integer_vars = root->integer_vars;
+        problem->binary_vars = root->binary_vars;
+        // The warm-start base isn't made of slacks, and the branching rows barely change the density
+        problem->density = root->density;
+        return problem;
+    }
+
+    /***
+     * Returns the integer variable whose value is the most fractional in x,
+     * or -1 if all the integer variables are integral.
+     */
+    int branching_var(const VectorXd& x, const VectorXi& integer_vars) {
+        int var = -1;
+        double best_dist = INTEGRALITY_TOL;
+        for (int i = 0; i < integer_vars.size(); ++i) {
+            double value = x(integer_vars(i));
+            double dist = abs(value - round(value));
+            if (dist > best_dist) {
+                best_dist = dist;
+                var = integer_vars(i);
+            }
+        }
+        return var;
+    }
+
+    /***
+     * The nodes owned by one worker.
+     * In best-bound mode they are kept in a heap with the lowest bound on top.
+     * In depth-first mode the owner pops the most recent node while thieves
+     * take the oldest (i.e. shallowest, with the largest subtree) one.
+     */
+    class NodePool {
+        mutex lock;
+        vector<Node*> nodes;
+        NodeSelection selection;
+
+        static bool worse_bound(const Node* a, const Node* b) {
+            return a->bound > b->bound || (a->bound == b->bound && a->depth < b->depth);
+        }
+
+        Node* pop_best() {
+            pop_heap(nodes.begin(), nodes.end(), worse_bound);
+            Node* node = nodes.back();
+            nodes.pop_back();
+            return node;
+        }
+
+    public:
+        explicit NodePool(NodeSelection selection) : selection(selection) {}
+
+        ~NodePool() {
+            for (Node* node : nodes) delete node;
+        }
+
+        void push(Node* node) {
+            lock_guard<mutex> guard(lock);
+            nodes.push_back(node);
+            if (selection == BEST_BOUND)
+                push_heap(nodes.begin(), nodes.end(), worse_bound);
+        }
+
+        Node* pop() {
+            lock_guard<mutex> guard(lock);
+            if (nodes.empty()) return nullptr;
+            if (selection == BEST_BOUND) return pop_best();
+            Node* node = nodes.back();
+            nodes.pop_back();
+            return node;
+        }
+
+        Node* steal() {
+            lock_guard<mutex> guard(lock);
+            if (nodes.empty()) return nullptr;
+            if (selection == BEST_BOUND) return pop_best();
+            Node* node = nodes.front();
+            nodes.erase(nodes.begin());
+            return node;
+        }
+    };
+
+    struct SharedState {
+        const Problem* root;
+        vector<unique_ptr<NodePool>> pools;
+        // Nodes pushed but not processed yet, the search is over when it drops to 0
+        atomic<long> open_nodes;
+        atomic<long> processed_nodes;
+        atomic<long> dropped_nodes;
+
+        // Read without the lock to prune, only written with it
+        atomic<double> incumbent;
+        VectorXd incumbent_solution;
+        mutex incumbent_lock;
+
+        atomic<bool> failed;
+        exception_ptr error;
+        mutex error_lock;
+        mutex output_lock;
+        int verbose_level;
+    };
+
+    static void update_incumbent(SharedState& state, double objective, const VectorXd& x) {
+        lock_guard<mutex> guard(state.incumbent_lock);
+        if (objective < state.incumbent) {
+            state.incumbent = objective;
+            state.incumbent_solution = x.head(state.root->A.cols());
+            if (state.verbose_level > -1) {
+                lock_guard<mutex> output_guard(state.output_lock);
+                cout << "incumbent\t= " << objective << endl;
+            }
+        }
+    }
+
+    static void process_node(SharedState& state, const Node* node, int worker) {
+        if (node->bound >= state.incumbent - PRUNE_TOL)
+            return;
+
+        unique_ptr<Problem> problem(get_node_problem(state.root, node->bounds, node->basic_vars));
+        double objective;
+        try {
+            // The root base is primal feasible, the children's ones are dual feasible
+            if (node->depth == 0)
+                perform_simplex(problem.get(), -1);
+            else
+                perform_dual_simplex(problem.get(), -1);
+            // Ran out of iterations without concluding, the subtree is lost and the search incomplete
+            state.dropped_nodes++;
+            if (state.verbose_level > -1) {
+                lock_guard<mutex> guard(state.output_lock);
+                cerr << "node at depth " << node->depth << " dropped, iteration limit reached" << endl;
+            }
+            return;
+        } catch (OptimalReachedException &e) {
+            objective = e.getValue();
+        } catch (InfeasibleProblemException &) {
+            return;
+        }
+
+        if (state.verbose_level > 0) {
+            lock_guard<mutex> guard(state.output_lock);
+            cout << "worker " << worker << "\tdepth " << node->depth << "\tobj = " << objective << endl;
+        }
+        if (objective >= state.incumbent - PRUNE_TOL)
+            return;
+
+        VectorXd x = get_solution_vector(problem.get());
+        int var = branching_var(x, state.root->integer_vars);
+        if (var == -1) {
+            update_incumbent(state, objective, x);
+            return;
+        }
+
+        // The child pushed last is explored first in depth-first mode
+        bool down_first = x(var) - floor(x(var)) < 0.5;
+        for (int k = 0; k < 2; ++k) {
+            bool is_upper = (k == 1) == down_first;
+            auto* child = new Node;
+            child->bounds = node->bounds;
+            child->bounds.push_back({var, is_upper ? floor(x(var)) : ceil(x(var)), is_upper});
+            child->basic_vars = problem->basic_vars;
+            child->bound = objective;
+            child->depth = node->depth + 1;
+            state.open_nodes++;
+            state.pools[worker]->push(child);
+        }
+    }
+
+    static void worker_loop(SharedState& state, int worker) {
+        long worker_count = state.pools.size();
+        while (!state.failed) {
+            Node* node = state.pools[worker]->pop();
+            for (long k = 1; node == nullptr && k < worker_count; ++k) {
+                node = state.pools[(worker + k) % worker_count]->steal();
+            }
+            if (node == nullptr) {
+                if (state.open_nodes == 0) break;
+                this_thread::yield();
+                continue;
+            }
+
+            try {
+                process_node(state, node, worker);
+            } catch (...) {
+                lock_guard<mutex> guard(state.error_lock);
+                if (!state.failed) state.error = current_exception();
+                state.failed = true;
+            }
+            delete node;
+            state.processed_nodes++;
+            // Children were counted before this, so it can't wrongly reach 0
+            state.open_nodes--;
+        }
+    }
+
+    Result perform_branch_and_bound(const Problem* problem, NodeSelection selection, int thread_count, int verbose_level) {
+        if (thread_count <= 0)
+            thread_count = max(1u, thread::hardware_concurrency());
+
+        SharedState state;
+        state.root = problem;
+        for (int i = 0; i < thread_count; ++i) {
+            state.pools.emplace_back(new NodePool(selection));
+        }
+        state.open_nodes = 1;
+        state.processed_nodes = 0;
+        state.dropped_nodes = 0;
+        state.incumbent = numeric_limits<double>::infinity();
+        state.failed = false;
+        state.verbose_level = verbose_level;
+
+        // Binary variables are bounded by 1 from the root on
+        auto* root = new Node;
+        for (int i = 0; i < problem->binary_vars.size(); ++i) {
+            root->bounds.push_back({problem->binary_vars(i), 1, true});
+        }
+        root->basic_vars = problem->basic_vars;
+        root->bound = -numeric_limits<double>::infinity();
+        root->depth = 0;
+        state.pools[0]->push(root);
+
+        auto start = chrono::steady_clock::now();
+        vector<thread> workers;
+        for (int i = 0; i < thread_count; ++i) {
+            workers.emplace_back(worker_loop, ref(state), i);
+        }
+        for (thread &worker : workers) {
+            worker.join();
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        if (state.failed)
+            rethrow_exception(state.error);
+        if (std::isinf(state.incumbent)) {
+            if (state.dropped_nodes > 0)
+                throw IterationLimitException();
+            throw InfeasibleProblemException();
+        }
+
+        return {state.incumbent, state.incumbent_solution, state.processed_nodes, state.dropped_nodes,
+                elapsed.count()};
+    }
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2020 Samuel Prevost.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SIMPLEXCPP_BRANCHANDBOUND_H
+#define SIMPLEXCPP_BRANCHANDBOUND_H
+
+#include <vector>
+#include <Eigen/Dense>
+#include "Problem.h"
+#include "Simplex.h"
+#include "SimplexException.h"
+
+using namespace std;
+using Eigen::VectorXd;
+using Eigen::VectorXi;
+
+namespace BranchAndBound {
+
+    enum NodeSelection { BEST_BOUND, DEPTH_FIRST };
+
+    /***
+     * A branching decision, i.e. x_var <= value when is_upper, x_var >= value otherwise.
+     * It is added to the problem as a new row along with its own slack column.
+     */
+    struct BranchBound {
+        int var;
+        double value;
+        bool is_upper;
+    };
+
+    struct Node {
+        vector<BranchBound> bounds;
+        // Optimal base of the parent relaxation, used to warm-start the dual simplex
+        VectorXi basic_vars;
+        // Objective of the parent relaxation, a lower bound on anything found below this node
+        double bound;
+        int depth;
+    };
+
+    struct Result {
+        double objective;
+        VectorXd solution;
+        long nodes;
+        // Nodes whose relaxation hit the iteration limit, the objective is only proven optimal when 0
+        long dropped_nodes;
+        double seconds;
+
+        double nodes_per_sec() const;
+    };
+
+    Problem* get_node_problem(const Problem* root, const vector<BranchBound>& bounds, const VectorXi& basic_vars);
+
+    int branching_var(const VectorXd& x, const VectorXi& integer_vars);
+
+    /***
+     * Solves the integer problem by branch-and-bound, using the simplex on the relaxations.
+     * Nodes are spread over thread_count workers (all the cores when <= 0) which steal
+     * each other's nodes when they run out, and share the incumbent to prune.
+     * The given problem is left untouched.
+     * @throws InfeasibleProblemException if no integer solution exists
+     * @throws IterationLimitException if none was found but some nodes hit the iteration limit
+     * @throws UnboundedProblemException if the relaxation is unbounded
+     */
+    Result perform_branch_and_bound(const Problem* problem, NodeSelection selection, int thread_count, int verbose_level);
+
+}
+
+#endif //SIMPLEXCPP_BRANCHANDBOUND_H
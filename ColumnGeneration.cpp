@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2020 Samuel Prevost.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ColumnGeneration.h"
+
+// Columns must have a reduced cost below -REDUCED_COST_TOL to enter the master
+#define REDUCED_COST_TOL 1e-9
+
+using namespace Simplex;
+
+namespace ColumnGeneration {
+
+    RestrictedMaster::RestrictedMaster(Problem* problem) {
+        this->problem = problem;
+        this->column_ids = vector<int>(problem->A.cols(), -1);
+        this->column_ages = vector<int>(problem->A.cols(), 0);
+        this->is_factored = false;
+    }
+
+    void RestrictedMaster::add_columns(const vector<Column>& columns) {
+        MatrixXd new_A(problem->A.rows(), columns.size());
+        VectorXd new_costs(columns.size());
+        for (int j = 0; j < columns.size(); ++j) {
+            new_A.col(j) = columns[j].coefficients;
+            new_costs(j) = columns[j].cost;
+            column_ids.push_back(columns[j].id);
+            column_ages.push_back(0);
+        }
+        problem->append_columns(new_A, new_costs);
+    }
+
+    void RestrictedMaster::drop_stale_columns(int max_age) {
+        vector<bool> is_basic(column_ids.size(), false);
+        for (int i = 0; i < problem->basic_vars.size(); ++i) {
+            is_basic[problem->basic_vars(i)] = true;
+        }
+        vector<int> stale, kept_ids, kept_ages;
+        for (int j = 0; j < column_ids.size(); ++j) {
+            // Basic columns start over at 0 and are never dropped, the others get one round older
+            int age = is_basic[j] ? 0 : column_ages[j] + 1;
+            if (!is_basic[j] && column_ids[j] != -1 && age > max_age) {
+                stale.push_back(j);
+            } else {
+                kept_ids.push_back(column_ids[j]);
+                kept_ages.push_back(age);
+            }
+        }
+        if (stale.empty()) {
+            column_ages = kept_ages;
+            return;
+        }
+        VectorXi indices(stale.size());
+        for (int i = 0; i < stale.size(); ++i) {
+            indices(i) = stale[i];
+        }
+        problem->drop_columns(indices);
+        column_ids = kept_ids;
+        column_ages = kept_ages;
+    }
+
+    double reduced_cost(const Column& column, const VectorXd& mults) {
+        return column.cost - mults.dot(column.coefficients);
+    }
+
+    /***
+     * Solves the master with the backend perform_simplex would pick, the dense one
+     * carrying on from the master's factorization.
+     */
+    static void solve_master(RestrictedMaster& master, int verbose_level) {
+        Problem* problem = master.problem;
+        if (!DenseBackend::uses_dense_backend(problem)) {
+            master.is_factored = false;
+            perform_simplex(problem, verbose_level);
+        } else {
+            if (!master.is_factored) {
+                master.factorization.refactor(problem->A, problem->basic_vars);
+                master.is_factored = true;
+            }
+            DenseBackend::perform_dense_simplex(problem, master.factorization, verbose_level);
+        }
+        throw IterationLimitException();
+    }
+
+    void perform_column_generation(RestrictedMaster& master, const PricingCallback& pricing, int max_age, int verbose_level) {
+        for (int i = 0; i < 1000; ++i) {
+            double objective;
+            try {
+                solve_master(master, verbose_level - 1);
+            } catch (OptimalReachedException &e) {
+                objective = e.getValue();
+            }
+
+            Problem* problem = master.problem;
+            if (!master.is_factored) {
+                master.factorization.refactor(problem->A, problem->basic_vars);
+                master.is_factored = true;
+            }
+            VectorXd mults = master.factorization.btran(slice_rows(problem->costs, problem->basic_vars));
+
+            vector<Column> columns;
+            for (const Column& column : pricing(mults)) {
+                if (reduced_cost(column, mults) < -REDUCED_COST_TOL)
+                    columns.push_back(column);
+            }
+            if (verbose_level > 0) {
+                cout << "-------------- pricing #" << i << " --------------" << endl;
+                cout << "obj  \t= " << objective << endl;
+                cout << "mults\t= [" << mults.transpose() << "]" << endl;
+                cout << "cols \t= " << problem->A.cols() << " (+" << columns.size() << ")" << endl;
+            }
+            if (columns.empty())
+                throw OptimalReachedException(objective);
+
+            // Only nonbasic columns come and go, so the base and its factorization are kept as is
+            master.drop_stale_columns(max_age);
+            master.add_columns(columns);
+        }
+        throw IterationLimitException();
+    }
+
+}
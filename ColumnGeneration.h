@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020 Samuel Prevost.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SIMPLEXCPP_COLUMNGENERATION_H
+#define SIMPLEXCPP_COLUMNGENERATION_H
+
+#include <functional>
+#include <vector>
+#include <Eigen/Dense>
+#include "DenseBackend.h"
+#include "Problem.h"
+#include "Simplex.h"
+#include "SimplexException.h"
+
+using namespace std;
+using Eigen::VectorXd;
+
+namespace ColumnGeneration {
+
+    /***
+     * A candidate variable produced by the pricing callback.
+     * id is chosen by the user to recognise the column in the solution.
+     */
+    struct Column {
+        int id;
+        VectorXd coefficients;
+        double cost;
+    };
+
+    /***
+     * Called with the current simplex multipliers, should return columns
+     * with a negative reduced cost (cost - mults^T.coefficients), or none
+     * when there are no such columns left.
+     */
+    typedef function<vector<Column>(const VectorXd& mults)> PricingCallback;
+
+    /***
+     * The problem restricted to the columns generated so far.
+     * The problem it starts from must have a feasible base, like for perform_simplex.
+     */
+    struct RestrictedMaster {
+        Problem* problem;
+        // Id of each column of problem->A, -1 for the columns the problem started with
+        vector<int> column_ids;
+        // Consecutive pricing rounds each column has spent out of the base
+        vector<int> column_ages;
+        // Factorization of the current base, left untouched by adding and dropping nonbasic columns
+        DenseBackend::DenseFactorization factorization;
+        // Whether factorization matches problem->basic_vars, the generic backend doesn't maintain it
+        bool is_factored;
+
+        explicit RestrictedMaster(Problem* problem);
+
+        void add_columns(const vector<Column>& columns);
+
+        void drop_stale_columns(int max_age);
+    };
+
+    double reduced_cost(const Column& column, const VectorXd& mults);
+
+    /***
+     * Alternates between solving the restricted master and pricing new columns,
+     * dropping generated columns which stayed out of the base for more than max_age rounds
+     * (any generated column out of the base when max_age < 0). Basic columns are never dropped.
+     * The multipliers come from the master's factorization, which the dense backend carries
+     * over from one round to the next rather than refactoring the base.
+     * @throws OptimalReachedException once no column can improve the objective
+     * @throws IterationLimitException if the master or the pricing rounds ran out of iterations
+     * @throws UnboundedProblemException if the master is unbounded
+     */
+    void perform_column_generation(RestrictedMaster& master, const PricingCallback& pricing, int max_age, int verbose_level);
+
+}
+
+#endif //SIMPLEXCPP_COLUMNGENERATION_H
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2020 Samuel Prevost.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DenseBackend.h"
+#include "Simplex.h"
+
+// Number of eta matrices kept before the base is refactored
+#define ETA_BATCH 32
+// Pivots smaller than this, relative to the largest entry of the entering column,
+// are too unstable to be kept as an eta, the base is refactored instead
+#define ETA_PIVOT_TOL 1e-7
+// Below this reciprocal condition number, the decomposition is only kept
+// until the next pivot rather than being extended with etas
+#define ILL_CONDITIONED_TOL 1e-6
+
+using namespace Simplex;
+
+namespace DenseBackend {
+
+    void DenseFactorization::refactor(const MatrixXd& A, const VectorXi& basic_vars) {
+        base = slice_cols(A, basic_vars);
+        // Blocked decomposition, most of the work happens in matrix-matrix products
+        lu.compute(base);
+        refactor_count++;
+        if (is_singular(lu)) {
+            throw SingularBaseException();
+        }
+        refactor_on_update = base.size() > 0 && lu.rcond() < ILL_CONDITIONED_TOL;
+        etas.resize(A.rows(), ETA_BATCH);
+        eta_rows.clear();
+    }
+
+    VectorXd DenseFactorization::ftran(const VectorXd& a) const {
+        VectorXd x = lu.solve(a);
+        // x <- E_k * ... * E_1 * x
+        for (int k = 0; k < eta_rows.size(); ++k) {
+            int row = eta_rows[k];
+            double x_row = x(row);
+            x += x_row * etas.col(k);
+            x(row) = x_row * etas(row, k);
+        }
+        return x;
+    }
+
+    VectorXd DenseFactorization::btran(const VectorXd& c) const {
+        VectorXd y = c;
+        // y^T <- y^T * E_k * ... * E_1, only the pivot row of y changes each time
+        for (int k = eta_rows.size() - 1; k >= 0; --k) {
+            y(eta_rows[k]) = y.dot(etas.col(k));
+        }
+        return lu.transpose().solve(y);
+    }
+
+    void DenseFactorization::update(int row, const VectorXd& alpha, const MatrixXd& A, const VectorXi& basic_vars) {
+        if (refactor_on_update || eta_rows.size() == ETA_BATCH ||
+            abs(alpha(row)) < ETA_PIVOT_TOL * alpha.cwiseAbs().maxCoeff()) {
+            refactor(A, basic_vars);
+            return;
+        }
+        int k = eta_rows.size();
+        etas.col(k) = -alpha / alpha(row);
+        etas(row, k) = 1 / alpha(row);
+        eta_rows.push_back(row);
+    }
+
+    long DenseFactorization::refactorizations() const {
+        return refactor_count;
+    }
+
+    bool uses_dense_backend(const Problem* problem) {
+        return problem->density >= DENSE_BACKEND_DENSITY;
+    }
+
+    double dense_simplex_iteration(Problem* problem, DenseFactorization& factorization, bool verbose) {
+        const MatrixXd &A = problem->A;
+        const VectorXd &b = problem->b;
+        const VectorXd &costs = problem->costs;
+        VectorXi &basic_vars = problem->basic_vars;
+
+        VectorXd mults = factorization.btran(slice_rows(costs, basic_vars));
+
+        // Unlike the generic iteration, B^-1 * A is never formed: only the entering column is needed
+        VectorXd new_c = costs - A.transpose() * mults;
+        VectorXd new_b = factorization.ftran(b);
+        double objective_value = mults.dot(b);
+
+        if (is_optimal(new_c, basic_vars))
+            throw OptimalReachedException(objective_value);
+
+        if (verbose) {
+            cout << "mults\t= [" << mults.transpose() << "]" << endl;
+            cout << "new_c\t= [" << (new_c).transpose() << "]" << endl;
+            cout << "new_b\t= [" << (new_b).transpose() << "]" << endl;
+        }
+
+        int col = pivot_col(new_c, basic_vars);
+        VectorXd alpha = factorization.ftran(A.col(col));
+        int row = pivot_row(alpha, new_b, 0);
+        // Update base
+        basic_vars(row) = col;
+        factorization.update(row, alpha, A, basic_vars);
+
+        if (verbose) {
+            cout << "B-1*a\t= [" << alpha.transpose() << "]" << endl;
+            cout << "pivot\t= (" << row << ", " << col << ")" << endl;
+            cout << "base  \t= " << basic_vars.transpose() << endl;
+        }
+
+        return objective_value;
+    }
+
+    double perform_dense_simplex(Problem* problem, int verbose_level) {
+        DenseFactorization factorization;
+        factorization.refactor(problem->A, problem->basic_vars);
+        return perform_dense_simplex(problem, factorization, verbose_level);
+    }
+
+    double perform_dense_simplex(Problem* problem, DenseFactorization& factorization, int verbose_level) {
+        double objective = numeric_limits<double>::infinity();
+        for (int i = 0; i < 1000; ++i) {
+            if (verbose_level > 0) cout << "-------------- dense it #" << i << " --------------" << endl;
+            objective = dense_simplex_iteration(problem, factorization, verbose_level >= 2);
+            if (verbose_level > 0) cout << "obj  \t= " << objective << endl;
+        }
+        return objective;
+    }
+
+}
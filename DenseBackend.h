@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2020 Samuel Prevost.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SIMPLEXCPP_DENSEBACKEND_H
+#define SIMPLEXCPP_DENSEBACKEND_H
+
+#include <vector>
+#include <Eigen/Dense>
+#include "Problem.h"
+#include "SimplexException.h"
+
+using namespace std;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+using Eigen::VectorXi;
+using Eigen::PartialPivLU;
+
+// Problems with at least this share of non zero coefficients are solved with the dense backend
+#define DENSE_BACKEND_DENSITY 0.3
+
+namespace DenseBackend {
+
+    /***
+     * Keeps the inverse of the base as the LU decomposition of its columns,
+     * taken when it was last refactored, followed by the eta matrices of the
+     * pivots made since. The etas are applied on the fly and only folded into
+     * a new LU once enough of them piled up, so each iteration costs a few
+     * triangular solves instead of a full inversion.
+     */
+    class DenseFactorization {
+        // Columns of the base, contiguous for the decomposition
+        MatrixXd base;
+        PartialPivLU<MatrixXd> lu;
+        // Column k holds the eta vector of the k-th pivot since the last refactorization
+        MatrixXd etas;
+        vector<int> eta_rows;
+        long refactor_count = 0;
+        // Etas can't make up for the rounding errors of an ill-conditioned decomposition
+        bool refactor_on_update = false;
+
+    public:
+        void refactor(const MatrixXd& A, const VectorXi& basic_vars);
+
+        // Returns B^-1 * a
+        VectorXd ftran(const VectorXd& a) const;
+
+        // Returns c^T * B^-1
+        VectorXd btran(const VectorXd& c) const;
+
+        /***
+         * Records the pivot on row, alpha being B^-1 times the entering column.
+         * basic_vars must already hold the new base, which is refactored when needed.
+         */
+        void update(int row, const VectorXd& alpha, const MatrixXd& A, const VectorXi& basic_vars);
+
+        // Number of LU decompositions taken so far
+        long refactorizations() const;
+    };
+
+    bool uses_dense_backend(const Problem* problem);
+
+    double dense_simplex_iteration(Problem* problem, DenseFactorization& factorization, bool verbose);
+
+    /***
+     * @throws SingularBaseException if the base can't be factored
+     */
+    double perform_dense_simplex(Problem* problem, int verbose_level);
+
+    /***
+     * Same as above, carrying on from factorization which must match problem->basic_vars.
+     * It is kept up to date with the base, so it can be reused as long as the base columns stay.
+     */
+    double perform_dense_simplex(Problem* problem, DenseFactorization& factorization, int verbose_level);
+
+}
+
+#endif //SIMPLEXCPP_DENSEBACKEND_H
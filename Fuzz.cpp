@@ -0,0 +1,665 @@
+/*
+ * Copyright (c) 2020 Samuel Prevost.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include "Fuzz.h"
+#include "Simplex.h"
+#include "BranchAndBound.h"
+#include "ColumnGeneration.h"
+#include "DenseBackend.h"
+
+// Relative tolerance used to compare objectives and check the certificates
+#define CHECK_TOL 1e-6
+// Threads used by the parallel branch-and-bound runs
+#define FUZZ_THREADS 4
+// An engine regresses when it needs this much more iterations than its baseline
+#define ITERATION_SLACK 0.10
+// Same for the node counts of parallel branch-and-bound, which vary with thread scheduling
+#define PARALLEL_NODE_SLACK 0.5
+// Or when it takes this much more time than its baseline, on top of MIN_CHECKED_SECONDS
+#define TIME_SLACK 0.5
+// Engine totals below this are mostly noise, their time isn't checked
+#define MIN_CHECKED_SECONDS 0.1
+
+using namespace Simplex;
+
+namespace Fuzz {
+
+    static bool close(double a, double b) {
+        return abs(a - b) <= CHECK_TOL * (1 + max(abs(a), abs(b)));
+    }
+
+    static const char* status_name(Status status) {
+        switch (status) {
+            case OPTIMAL: return "optimal";
+            case UNBOUNDED: return "unbounded";
+            case INFEASIBLE: return "infeasible";
+            case SINGULAR: return "singular";
+            default: return "iteration limit";
+        }
+    }
+
+    /***
+     * The standard distributions are implementation-defined and draw differently with each
+     * standard library. These only rely on the output of mt19937, which is fully specified,
+     * so the problems and the baseline are the same whatever the toolchain.
+     */
+    struct UniformInt {
+        int low, high;
+        UniformInt(int low, int high) : low(low), high(high) {}
+        int operator()(mt19937& rng) const {
+            return low + (int) (rng() % (high - low + 1));
+        }
+    };
+
+    struct Uniform {
+        double low, high;
+        Uniform(double low, double high) : low(low), high(high) {}
+        double operator()(mt19937& rng) const {
+            return low + (high - low) * (rng() / ((double) mt19937::max() + 1));
+        }
+    };
+
+    // Sum of 12 uniforms on [0, 1) minus 6, close enough to a standard normal for the tests
+    struct Normal {
+        double operator()(mt19937& rng) const {
+            Uniform unit(0, 1);
+            double sum = -6;
+            for (int k = 0; k < 12; ++k) sum += unit(rng);
+            return sum;
+        }
+    };
+
+    /* Problem generators, all of them start from a slack base */
+
+    static Problem* with_slacks(const MatrixXd& A, const VectorXd& b, const VectorXd& costs) {
+        long m = A.rows(), n = A.cols();
+        MatrixXd full_A(m, n + m);
+        full_A << A, MatrixXd::Identity(m, m);
+        VectorXd full_costs = VectorXd::Zero(n + m);
+        full_costs.head(n) = costs;
+        VectorXi basic_vars(m);
+        for (int i = 0; i < m; ++i) {
+            basic_vars(i) = n + i;
+        }
+        return new Problem(full_A, b, full_costs, basic_vars);
+    }
+
+    /***
+     * Mixed sign constraints with a non negative bias, so that the slack base is feasible.
+     * These may well be unbounded.
+     */
+    Problem* get_random_problem(mt19937& rng) {
+        UniformInt height(1, 15), width(1, 17);
+        Uniform coeff(-50, 50), bias(0, 50);
+        int m = height(rng), n = width(rng);
+        MatrixXd A(m, n);
+        VectorXd b(m), costs(n);
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < n; ++j) A(i, j) = coeff(rng);
+            b(i) = bias(rng);
+        }
+        for (int j = 0; j < n; ++j) costs(j) = coeff(rng);
+        return with_slacks(A, b, costs);
+    }
+
+    /***
+     * max profit.x such that A.x <= b with A >= 0 and every variable used somewhere,
+     * always feasible and bounded.
+     */
+    Problem* get_packing_problem(mt19937& rng) {
+        UniformInt height(2, 12), width(2, 25);
+        Uniform coeff(1, 20), bias(10, 100), unit(0, 1);
+        int m = height(rng), n = width(rng);
+        MatrixXd A = MatrixXd::Zero(m, n);
+        VectorXd b(m), costs(n);
+        for (int j = 0; j < n; ++j) {
+            int row = rng() % m;
+            A(row, j) = coeff(rng);
+            for (int i = 0; i < m; ++i) {
+                if (unit(rng) < 0.3) A(i, j) = coeff(rng);
+            }
+            costs(j) = -coeff(rng);
+        }
+        for (int i = 0; i < m; ++i) b(i) = bias(rng);
+        return with_slacks(A, b, costs);
+    }
+
+    /***
+     * min costs.x such that A.x >= b with A >= 0 and costs > 0, written as -A.x <= -b.
+     * The slack base is dual feasible but not primal feasible: a job for the dual simplex.
+     */
+    Problem* get_covering_problem(mt19937& rng) {
+        UniformInt height(2, 12), width(2, 25);
+        Uniform coeff(1, 20), bias(10, 100), unit(0, 1);
+        int m = height(rng), n = width(rng);
+        MatrixXd A = MatrixXd::Zero(m, n);
+        VectorXd b(m), costs(n);
+        for (int i = 0; i < m; ++i) {
+            int col = rng() % n;
+            A(i, col) = -coeff(rng);
+            for (int j = 0; j < n; ++j) {
+                if (unit(rng) < 0.3) A(i, j) = -coeff(rng);
+            }
+            b(i) = -bias(rng);
+        }
+        for (int j = 0; j < n; ++j) costs(j) = coeff(rng);
+        return with_slacks(A, b, costs);
+    }
+
+    /***
+     * A small packing problem with integer coefficients, some variables being integer
+     * and some of those binary.
+     */
+    Problem* get_integer_problem(mt19937& rng) {
+        UniformInt height(1, 4), width(2, 7), coeff(1, 9), bias(5, 40);
+        int m = height(rng), n = width(rng);
+        MatrixXd A(m, n);
+        VectorXd b(m), costs(n);
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < n; ++j) A(i, j) = coeff(rng);
+            b(i) = bias(rng);
+        }
+        for (int j = 0; j < n; ++j) costs(j) = -coeff(rng);
+        Problem* problem = with_slacks(A, b, costs);
+
+        vector<int> integers, binaries;
+        for (int j = 0; j < n; ++j) {
+            int kind = rng() % 3;
+            if (kind > 0) integers.push_back(j);
+            if (kind == 2) binaries.push_back(j);
+        }
+        if (integers.empty()) integers.push_back(0);
+        problem->integer_vars = Eigen::Map<VectorXi>(integers.data(), integers.size());
+        problem->binary_vars = Eigen::Map<VectorXi>(binaries.data(), binaries.size());
+        return problem;
+    }
+
+    /***
+     * A 40% dense packing problem wide enough to take well over ETA_BATCH pivots,
+     * with its coefficients scaled down by up to a few hundred times half of the time.
+     */
+    Problem* get_dense_problem(mt19937& rng) {
+        UniformInt height(60, 80);
+        Uniform coeff(1, 10), bias(50, 100), unit(0, 1);
+        int m = height(rng), n = 2 * m;
+        double scale = (rng() % 2) ? 1 : 0.005;
+        MatrixXd A = MatrixXd::Zero(m, n);
+        VectorXd b(m), costs(n);
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < m; ++i) {
+                if (unit(rng) < 0.4) A(i, j) = scale * coeff(rng);
+            }
+            int row = rng() % m;
+            A(row, j) = scale * coeff(rng);
+            costs(j) = -coeff(rng);
+        }
+        for (int i = 0; i < m; ++i) b(i) = bias(rng);
+        return with_slacks(A, b, costs);
+    }
+
+    string check_certificate(Problem* problem, double objective) {
+        ostringstream error;
+        VectorXd x = get_solution_vector(problem);
+        MatrixXd inverse_base = get_inverse_base_matrix(problem->A, problem->basic_vars);
+        VectorXd mults = get_simplex_mults(inverse_base, problem->costs, problem->basic_vars);
+        VectorXd reduced_costs = problem->costs - problem->A.transpose() * mults;
+        double scale = 1 + problem->A.cwiseAbs().maxCoeff() + problem->b.cwiseAbs().maxCoeff();
+
+        if ((problem->A * x - problem->b).cwiseAbs().maxCoeff() > CHECK_TOL * scale)
+            error << "A.x != b ";
+        if (x.minCoeff() < -CHECK_TOL * scale)
+            error << "x < 0 (" << x.minCoeff() << ") ";
+        if (reduced_costs.minCoeff() < -CHECK_TOL * (1 + problem->costs.cwiseAbs().maxCoeff()))
+            error << "not dual feasible (" << reduced_costs.minCoeff() << ") ";
+        if (!close(problem->costs.dot(x), objective))
+            error << "c.x = " << problem->costs.dot(x) << " != " << objective << " ";
+        return error.str();
+    }
+
+    /***
+     * Drives a DenseFactorization through a long sequence of random pivots, some of them
+     * tiny enough to force a refactorization, and checks after each one that ftran and
+     * btran solve with the actual base. Residuals are used rather than the exact solutions
+     * as the forced pivots leave the base ill-conditioned for a step.
+     */
+    static string check_eta_file(mt19937& rng) {
+        Normal coeff;
+        int m = 10 + rng() % 20;
+        MatrixXd base(m, m);
+        for (int k = 0; k < base.size(); ++k) base(k) = coeff(rng);
+        VectorXi basic_vars = VectorXi::LinSpaced(m, 0, m - 1);
+        DenseBackend::DenseFactorization factorization;
+        factorization.refactor(base, basic_vars);
+
+        int tiny_row = -1, tiny_steps = 0, next_tiny = 9;
+        for (int step = 0; step < 100; ++step) {
+            // A tiny pivot leaves the base ill-conditioned, its row is replaced right after.
+            // It's only forced on a well-conditioned base, otherwise the result is rightly singular
+            int row = (tiny_row != -1) ? tiny_row : rng() % m;
+            bool tiny = tiny_row == -1 && step >= next_tiny && base.partialPivLu().rcond() > 1e-3;
+            if (tiny) {
+                tiny_steps++;
+                next_tiny = step + 10;
+            }
+            VectorXd a(m), alpha;
+            if (tiny) {
+                alpha = VectorXd(m);
+                for (int i = 0; i < m; ++i) alpha(i) = coeff(rng);
+                alpha(row) = 0;
+                alpha(row) = 5e-8 * alpha.cwiseAbs().maxCoeff();
+                a = base * alpha;
+            } else {
+                for (int i = 0; i < m; ++i) a(i) = coeff(rng);
+                alpha = factorization.ftran(a);
+            }
+            tiny_row = tiny ? row : -1;
+            long refactorizations = factorization.refactorizations();
+
+            base.col(row) = a;
+            factorization.update(row, alpha, base, basic_vars);
+            if (tiny && factorization.refactorizations() == refactorizations)
+                return "tiny pivot kept in the eta file at step " + to_string(step);
+
+            VectorXd v(m);
+            for (int i = 0; i < m; ++i) v(i) = coeff(rng);
+            VectorXd x = factorization.ftran(v), y = factorization.btran(v);
+            double norm = base.norm();
+            if ((base * x - v).norm() > 1e-9 * (norm * x.norm() + v.norm()))
+                return "ftran is off at step " + to_string(step);
+            if ((base.transpose() * y - v).norm() > 1e-9 * (norm * y.norm() + v.norm()))
+                return "btran is off at step " + to_string(step);
+        }
+        if (tiny_steps < 3)
+            return "only " + to_string(tiny_steps) + " tiny pivots forced";
+        return "";
+    }
+
+    /* Engines */
+
+    static double seconds_since(chrono::steady_clock::time_point start) {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    static Outcome solve_lp(Problem* problem, bool dual) {
+        Outcome outcome = {ITERATION_LIMIT, 0, 0, 0};
+        auto start = chrono::steady_clock::now();
+        try {
+            for (; outcome.iterations < 1000; ++outcome.iterations) {
+                if (dual)
+                    dual_simplex_iteration(problem, false);
+                else
+                    simplex_iteration(problem, false);
+            }
+        } catch (OptimalReachedException &e) {
+            outcome.status = OPTIMAL;
+            outcome.objective = e.getValue();
+        } catch (UnboundedProblemException &) {
+            outcome.status = UNBOUNDED;
+        } catch (SingularBaseException &) {
+            outcome.status = SINGULAR;
+        } catch (InfeasibleProblemException &) {
+            outcome.status = INFEASIBLE;
+        }
+        outcome.seconds = seconds_since(start);
+        return outcome;
+    }
+
+    static Outcome solve_dense(Problem* problem, long& refactorizations) {
+        Outcome outcome = {ITERATION_LIMIT, 0, 0, 0};
+        auto start = chrono::steady_clock::now();
+        DenseBackend::DenseFactorization factorization;
+        try {
+            factorization.refactor(problem->A, problem->basic_vars);
+            for (; outcome.iterations < 1000; ++outcome.iterations) {
+                DenseBackend::dense_simplex_iteration(problem, factorization, false);
+            }
+        } catch (OptimalReachedException &e) {
+            outcome.status = OPTIMAL;
+            outcome.objective = e.getValue();
+        } catch (UnboundedProblemException &) {
+            outcome.status = UNBOUNDED;
+        } catch (SingularBaseException &) {
+            outcome.status = SINGULAR;
+        }
+        refactorizations = factorization.refactorizations();
+        outcome.seconds = seconds_since(start);
+        return outcome;
+    }
+
+    /***
+     * Starts from the slack columns only and prices the others out of the full problem.
+     * The iterations are the pricing rounds.
+     */
+    static Outcome solve_column_generation(const Problem* problem) {
+        long m = problem->A.rows(), n = problem->A.cols() - m;
+        Outcome outcome = {ITERATION_LIMIT, 0, 0, 0};
+        auto start = chrono::steady_clock::now();
+        unique_ptr<Problem> restricted(new Problem(problem->A.rightCols(m), problem->b, VectorXd::Zero(m),
+                                                   VectorXi::LinSpaced(m, 0, m - 1)));
+        ColumnGeneration::RestrictedMaster master(restricted.get());
+        ColumnGeneration::PricingCallback pricing = [&](const VectorXd& mults) {
+            outcome.iterations++;
+            vector<ColumnGeneration::Column> columns;
+            for (int j = 0; j < n; ++j) {
+                ColumnGeneration::Column column = {j, problem->A.col(j), problem->costs(j)};
+                if (ColumnGeneration::reduced_cost(column, mults) < 0)
+                    columns.push_back(column);
+            }
+            return columns;
+        };
+        try {
+            ColumnGeneration::perform_column_generation(master, pricing, 2, -1);
+        } catch (OptimalReachedException &e) {
+            outcome.status = OPTIMAL;
+            outcome.objective = e.getValue();
+        } catch (IterationLimitException &) {
+            outcome.status = ITERATION_LIMIT;
+        } catch (UnboundedProblemException &) {
+            outcome.status = UNBOUNDED;
+        } catch (SingularBaseException &) {
+            outcome.status = SINGULAR;
+        }
+        outcome.seconds = seconds_since(start);
+        return outcome;
+    }
+
+    static string check_integer_solution(const Problem* problem, const BranchAndBound::Result& result) {
+        ostringstream error;
+        const VectorXd &x = result.solution;
+        if ((problem->A * x - problem->b).cwiseAbs().maxCoeff() > CHECK_TOL * (1 + problem->b.cwiseAbs().maxCoeff()))
+            error << "A.x != b ";
+        if (x.minCoeff() < -CHECK_TOL)
+            error << "x < 0 ";
+        for (int i = 0; i < problem->integer_vars.size(); ++i) {
+            double value = x(problem->integer_vars(i));
+            if (abs(value - round(value)) > CHECK_TOL)
+                error << "x" << problem->integer_vars(i) + 1 << " = " << value << " not integral ";
+        }
+        for (int i = 0; i < problem->binary_vars.size(); ++i) {
+            if (x(problem->binary_vars(i)) > 1 + CHECK_TOL)
+                error << "x" << problem->binary_vars(i) + 1 << " > 1 ";
+        }
+        if (!close(problem->costs.dot(x), result.objective))
+            error << "c.x != " << result.objective << " ";
+        return error.str();
+    }
+
+    static Outcome solve_mip(const Problem* problem, BranchAndBound::NodeSelection selection, int threads,
+                             string& error) {
+        Outcome outcome = {ITERATION_LIMIT, 0, 0, 0};
+        auto start = chrono::steady_clock::now();
+        try {
+            BranchAndBound::Result result = BranchAndBound::perform_branch_and_bound(problem, selection, threads, -1);
+            // An incomplete search proves nothing about the objective
+            outcome.status = (result.dropped_nodes > 0) ? ITERATION_LIMIT : OPTIMAL;
+            outcome.objective = result.objective;
+            outcome.iterations = result.nodes;
+            error = check_integer_solution(problem, result);
+        } catch (UnboundedProblemException &) {
+            outcome.status = UNBOUNDED;
+        } catch (SingularBaseException &) {
+            outcome.status = SINGULAR;
+        } catch (InfeasibleProblemException &) {
+            outcome.status = INFEASIBLE;
+        } catch (IterationLimitException &) {
+            outcome.status = ITERATION_LIMIT;
+        }
+        outcome.seconds = seconds_since(start);
+        return outcome;
+    }
+
+    /* Driver */
+
+    struct Case {
+        unsigned seed;
+        const char* family;
+        Problem* problem;
+        vector<string> failures;
+    };
+
+    static void record(map<string, EngineStats>& stats, const string& engine, const Outcome& outcome,
+                       bool parallel = false) {
+        EngineStats &engine_stats = stats[engine];
+        engine_stats.engine = engine;
+        engine_stats.parallel = parallel;
+        engine_stats.runs++;
+        engine_stats.iterations += outcome.iterations;
+        engine_stats.seconds += outcome.seconds;
+    }
+
+    static void compare(Case& c, const string& engine, const Outcome& outcome, const string& reference,
+                        const Outcome& expected) {
+        if (outcome.status != expected.status) {
+            c.failures.push_back(engine + " is " + status_name(outcome.status) + " but " + reference + " is " +
+                                 status_name(expected.status));
+        } else if (outcome.status == OPTIMAL && !close(outcome.objective, expected.objective)) {
+            ostringstream error;
+            error << engine << " found " << outcome.objective << " but " << reference << " found " << expected.objective;
+            c.failures.push_back(error.str());
+        }
+    }
+
+    /***
+     * Cross-checks the dual simplex on a covering problem -A.x <= -b by running the primal
+     * simplex on its explicit dual: min -b.y such that A^T.y <= costs, y >= 0, whose slack
+     * base is feasible since costs > 0. Both optima are opposite.
+     */
+    static void run_dualized_engine(Case& c, map<string, EngineStats>& stats, const Outcome& dual) {
+        long m = c.problem->A.rows(), n = c.problem->A.cols() - m;
+        MatrixXd A = -c.problem->A.leftCols(n);
+        unique_ptr<Problem> dualized(with_slacks(A.transpose(), c.problem->costs.head(n), c.problem->b));
+        Outcome outcome = solve_lp(dualized.get(), false);
+        record(stats, "primal-dualized", outcome);
+        if (outcome.status == OPTIMAL) {
+            string error = check_certificate(dualized.get(), outcome.objective);
+            if (!error.empty()) c.failures.push_back("primal-dualized: " + error);
+            outcome.objective = -outcome.objective;
+        } else if (outcome.status == UNBOUNDED) {
+            // An unbounded dual means an infeasible primal
+            outcome.status = INFEASIBLE;
+        }
+        compare(c, "primal-dualized", outcome, "dual", dual);
+    }
+
+    static void run_lp_engines(Case& c, map<string, EngineStats>& stats, bool dual) {
+        Problem problem = *c.problem;
+        string engine = dual ? "dual" : "primal";
+        Outcome outcome = solve_lp(&problem, dual);
+        record(stats, engine, outcome);
+        if (outcome.status == ITERATION_LIMIT)
+            c.failures.push_back(engine + " hit the iteration limit");
+        if (outcome.status == OPTIMAL) {
+            string error = check_certificate(&problem, outcome.objective);
+            if (!error.empty()) c.failures.push_back(engine + ": " + error);
+        }
+        if (dual) {
+            run_dualized_engine(c, stats, outcome);
+            return;
+        }
+
+        Problem dense_problem = *c.problem;
+        long refactorizations = 0;
+        Outcome dense = solve_dense(&dense_problem, refactorizations);
+        record(stats, "dense", dense);
+        compare(c, "dense", dense, engine, outcome);
+        // Both backends follow the same pivoting rules, even once the eta file was folded
+        if (dense.status == outcome.status && dense.iterations != outcome.iterations) {
+            c.failures.push_back("dense took " + to_string(dense.iterations) + " iterations but " + engine +
+                                 " took " + to_string(outcome.iterations));
+        }
+        if (string(c.family) == "dense") {
+            if (!DenseBackend::uses_dense_backend(c.problem))
+                c.failures.push_back("perform_simplex doesn't pick the dense backend");
+            if (refactorizations < 2)
+                c.failures.push_back("too few pivots to fold the eta file");
+            mt19937 rng(c.seed);
+            string error = check_eta_file(rng);
+            if (!error.empty()) c.failures.push_back("eta file: " + error);
+        }
+        if (dense.status == OPTIMAL) {
+            string error = check_certificate(&dense_problem, dense.objective);
+            if (!error.empty()) c.failures.push_back("dense: " + error);
+        }
+
+        Outcome generated = solve_column_generation(c.problem);
+        record(stats, "colgen", generated);
+        compare(c, "colgen", generated, engine, outcome);
+    }
+
+    static void run_mip_engines(Case& c, map<string, EngineStats>& stats) {
+        Problem relaxation = *c.problem;
+        Outcome lp = solve_lp(&relaxation, false);
+
+        Outcome reference = {ITERATION_LIMIT, 0, 0, 0};
+        string reference_name;
+        for (int threads : {1, FUZZ_THREADS}) {
+            for (BranchAndBound::NodeSelection selection : {BranchAndBound::BEST_BOUND, BranchAndBound::DEPTH_FIRST}) {
+                string engine = string("bb-") + (selection == BranchAndBound::BEST_BOUND ? "best" : "dfs") +
+                                "-j" + to_string(threads);
+                string error;
+                Outcome outcome = solve_mip(c.problem, selection, threads, error);
+                record(stats, engine, outcome, threads > 1);
+                if (!error.empty()) c.failures.push_back(engine + ": " + error);
+                if (outcome.status == ITERATION_LIMIT)
+                    c.failures.push_back(engine + " dropped nodes at the iteration limit");
+                if (reference_name.empty()) {
+                    reference = outcome;
+                    reference_name = engine;
+                } else {
+                    compare(c, engine, outcome, reference_name, reference);
+                }
+                // The relaxation can only be better than the integer optimum
+                if (outcome.status == OPTIMAL && lp.status == OPTIMAL && outcome.objective < lp.objective - CHECK_TOL) {
+                    c.failures.push_back(engine + " beats the relaxation");
+                }
+            }
+        }
+    }
+
+    Report run(unsigned seed, int count, int verbose_level) {
+        map<string, EngineStats> stats;
+        Report report = {0, 0, {}};
+        for (int i = 0; i < count; ++i) {
+            mt19937 rng(seed + i);
+            Case c = {seed + (unsigned) i, nullptr, nullptr, {}};
+            switch (i % 5) {
+                case 0: c.family = "random"; c.problem = get_random_problem(rng); break;
+                case 1: c.family = "packing"; c.problem = get_packing_problem(rng); break;
+                case 2: c.family = "covering"; c.problem = get_covering_problem(rng); break;
+                case 3: c.family = "integer"; c.problem = get_integer_problem(rng); break;
+                default: c.family = "dense"; c.problem = get_dense_problem(rng); break;
+            }
+
+            try {
+                if (c.problem->is_integer())
+                    run_mip_engines(c, stats);
+                else
+                    run_lp_engines(c, stats, c.problem->b.minCoeff() < 0);
+            } catch (exception &e) {
+                c.failures.push_back(string("unexpected exception: ") + e.what());
+            }
+
+            report.cases++;
+            if (!c.failures.empty()) {
+                report.failures++;
+                string filename = "fuzz_" + to_string(c.seed) + ".lp";
+                c.problem->save_glpsol(filename);
+                cerr << "FAIL " << c.family << " case, seed " << c.seed << " saved as " << filename << endl;
+                for (const string &failure : c.failures) {
+                    cerr << "\t" << failure << endl;
+                }
+            } else if (verbose_level > 0) {
+                cout << "ok   " << c.family << " case, seed " << c.seed << endl;
+            }
+            delete c.problem;
+        }
+        for (auto &engine_stats : stats) {
+            report.stats.push_back(engine_stats.second);
+        }
+        if (verbose_level > -1) {
+            cout << report.cases << " cases, " << report.failures << " failures" << endl;
+            cout << "engine\t\truns\titerations\tseconds" << endl;
+            for (const EngineStats &s : report.stats) {
+                cout << s.engine << "\t" << (s.engine.size() < 8 ? "\t" : "") << s.runs << "\t" << s.iterations;
+                cout << "\t\t" << s.seconds << endl;
+            }
+        }
+        return report;
+    }
+
+    void save_baseline(const Report& report, const string& filename) {
+        ofstream outStream(filename);
+        outStream << "\\Generated using Simplex, one line per engine: name runs iterations seconds" << endl;
+        for (const EngineStats &s : report.stats) {
+            outStream << s.engine << " " << s.runs << " " << s.iterations << " " << s.seconds << endl;
+        }
+    }
+
+    bool check_baseline(const Report& report, const string& filename, int verbose_level) {
+        ifstream is_file(filename);
+        if (!is_file.good()) {
+            cerr << "No baseline at " << filename << ", record one with -record" << endl;
+            return false;
+        }
+        map<string, EngineStats> baseline;
+        string line;
+        while (getline(is_file, line)) {
+            if (line.empty() || line[0] == '\\') continue;
+            istringstream is_line(line);
+            EngineStats s = {"", 0, 0, 0, false};
+            if (is_line >> s.engine >> s.runs >> s.iterations >> s.seconds)
+                baseline[s.engine] = s;
+        }
+
+        bool ok = true;
+        for (const EngineStats &s : report.stats) {
+            auto it = baseline.find(s.engine);
+            if (it == baseline.end()) {
+                cerr << s.engine << " has no baseline, record one with -record" << endl;
+                ok = false;
+                continue;
+            }
+            const EngineStats &base = it->second;
+            if (s.runs != base.runs) {
+                cerr << s.engine << " ran " << s.runs << " times against " << base.runs
+                     << " in the baseline, use the same seed and count" << endl;
+                ok = false;
+                continue;
+            }
+            double slack = s.parallel ? PARALLEL_NODE_SLACK : ITERATION_SLACK;
+            if (s.iterations > base.iterations * (1 + slack)) {
+                cerr << "REGRESSION " << s.engine << " iterations " << base.iterations << " -> " << s.iterations << endl;
+                ok = false;
+            } else if (verbose_level > 0) {
+                cout << s.engine << " iterations " << base.iterations << " -> " << s.iterations << endl;
+            }
+            if (base.seconds >= MIN_CHECKED_SECONDS &&
+                s.seconds > base.seconds * (1 + TIME_SLACK) + MIN_CHECKED_SECONDS) {
+                cerr << "REGRESSION " << s.engine << " seconds " << base.seconds << " -> " << s.seconds << endl;
+                ok = false;
+            } else if (verbose_level > 0) {
+                cout << s.engine << " seconds " << base.seconds << " -> " << s.seconds << endl;
+            }
+        }
+        return ok;
+    }
+
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020 Samuel Prevost.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SIMPLEXCPP_FUZZ_H
+#define SIMPLEXCPP_FUZZ_H
+
+#include <random>
+#include <string>
+#include <vector>
+#include "Problem.h"
+
+using namespace std;
+
+namespace Fuzz {
+
+    enum Status { OPTIMAL, UNBOUNDED, INFEASIBLE, SINGULAR, ITERATION_LIMIT };
+
+    struct Outcome {
+        Status status;
+        double objective;
+        long iterations;
+        double seconds;
+    };
+
+    struct EngineStats {
+        string engine;
+        long runs;
+        long iterations;
+        double seconds;
+        // Parallel branch-and-bound, whose node counts depend on thread scheduling
+        bool parallel;
+    };
+
+    struct Report {
+        long cases;
+        long failures;
+        vector<EngineStats> stats;
+    };
+
+    Problem* get_random_problem(mt19937& rng);
+    Problem* get_packing_problem(mt19937& rng);
+    Problem* get_covering_problem(mt19937& rng);
+    Problem* get_integer_problem(mt19937& rng);
+    Problem* get_dense_problem(mt19937& rng);
+
+    /***
+     * Checks that the base of a solved problem is primal and dual feasible
+     * and that it matches the objective value. Returns an empty string if so,
+     * what's wrong otherwise.
+     */
+    string check_certificate(Problem* problem, double objective);
+
+    /***
+     * Solves count seeded problems with every engine able to handle them,
+     * cross-checking the results. Case i only depends on seed + i, and the failing
+     * ones are saved as fuzz_<seed + i>.lp to be replayed.
+     */
+    Report run(unsigned seed, int count, int verbose_level);
+
+    void save_baseline(const Report& report, const string& filename);
+
+    /***
+     * Compares the iteration counts and wall times of report against the ones saved by save_baseline.
+     * Returns false if the baseline is missing or any engine regressed beyond the threshold.
+     * Wall times are only checked for engines taking long enough not to be mostly noise,
+     * and loosely since they depend on the machine.
+     */
+    bool check_baseline(const Report& report, const string& filename, int verbose_level);
+
+}
+
+#endif //SIMPLEXCPP_FUZZ_H
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2020 Samuel Prevost.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <cstring>
+#include "Fuzz.h"
+
+#define DEFAULT_BASELINE_FILE "fuzz_baseline.txt"
+#define DEFAULT_FUZZ_SEED 42
+#define DEFAULT_FUZZ_COUNT 400
+#define FLAG_HELP "-h"
+#define FLAG_QUIET "-q"
+#define FLAG_VERBOSE "-v"
+#define FLAG_SEED "-seed"
+#define FLAG_COUNT "-n"
+#define FLAG_BASELINE "-baseline"
+#define FLAG_RECORD "-record"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+
+    int verbose_level = 0;
+    unsigned seed = DEFAULT_FUZZ_SEED;
+    int count = DEFAULT_FUZZ_COUNT;
+    string baseline = DEFAULT_BASELINE_FILE;
+    bool record = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], FLAG_QUIET) == 0) {
+            verbose_level = -1;
+        } else if (strcmp(argv[i], FLAG_VERBOSE) == 0) {
+            verbose_level = 1;
+        } else if (strcmp(argv[i], FLAG_SEED) == 0 && i + 1 < argc) {
+            seed = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], FLAG_COUNT) == 0 && i + 1 < argc) {
+            count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], FLAG_BASELINE) == 0 && i + 1 < argc) {
+            baseline = argv[++i];
+        } else if (strcmp(argv[i], FLAG_RECORD) == 0) {
+            record = true;
+        } else {
+            cout << "Usage: " << argv[0] << " [" << FLAG_SEED << " seed] [" << FLAG_COUNT << " count] ";
+            cout << "[" << FLAG_BASELINE << " file] [" << FLAG_RECORD << "] ";
+            cout << "[" << FLAG_QUIET << " or " << FLAG_VERBOSE << "]";
+            cout << endl;
+            return strcmp(argv[i], FLAG_HELP) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    Fuzz::Report report = Fuzz::run(seed, count, verbose_level);
+    if (report.failures > 0)
+        return EXIT_FAILURE;
+    if (record) {
+        Fuzz::save_baseline(report, baseline);
+        if (verbose_level > -1) cout << "Baseline saved under " << baseline << endl;
+        return EXIT_SUCCESS;
+    }
+    return Fuzz::check_baseline(report, baseline, verbose_level) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
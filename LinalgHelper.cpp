@@ -15,6 +15,9 @@
 
 #include "LinalgHelper.h"
 
+// Smallest reciprocal condition number of a regular matrix
+#define SINGULAR_TOL 1e-12
+
 namespace LinalgHelper {
 
     MatrixXd slice_rows(const MatrixXd& to_slice, const VectorXi& indices){
@@ -26,7 +29,12 @@ namespace LinalgHelper {
     }
 
     MatrixXd slice_cols(const MatrixXd& to_slice, const VectorXi& indices) {
-        return slice_rows(to_slice.transpose(), indices).transpose();
+        // Columns are contiguous in memory, copy them directly rather than transposing twice
+        MatrixXd sliced(to_slice.rows(), indices.size());
+        for (int j = 0; j < indices.size(); ++j) {
+            sliced.col(j) = to_slice.col(indices(j));
+        }
+        return sliced;
     }
 
     int argmax(VectorXd v){
@@ -91,4 +99,14 @@ namespace LinalgHelper {
         }
         return opposite;*/
     }
-}
\ No newline at end of file
+
+    /***
+     * A matrix is considered singular when the estimate of its reciprocal condition
+     * number, taken from its LU decomposition, is negligible. Unlike the determinant,
+     * it doesn't under or overflow with the size or the scale of the matrix.
+     */
+    bool is_singular(const Eigen::PartialPivLU<MatrixXd>& lu){
+        if (lu.matrixLU().size() == 0) return false;
+        return !(lu.rcond() > SINGULAR_TOL);
+    }
+}
@@ -27,6 +27,7 @@ namespace LinalgHelper {
     int argmax(VectorXd v);
     int argmin(VectorXd v);
     VectorXi opposite_indices(const VectorXi& indices, int var_count);
+    bool is_singular(const Eigen::PartialPivLU<MatrixXd>& lu);
 };
 
 
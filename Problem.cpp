@@ -14,13 +14,17 @@
  */
 
 #include <fstream>
+#include <algorithm>
 #include "Problem.h"
+#include "LinalgHelper.h"
 
 Problem::Problem(const MatrixXd A, const VectorXd b, const VectorXd costs, VectorXi basic_vars){
     this->A = A;
     this->b = b;
     this->costs = costs;
     this->basic_vars = basic_vars;
+    // The starting base is expected to be made of the slack columns
+    this->density = measure_density(A, basic_vars);
 }
 /* File parsing functions */
 static VectorXd parse_vector(istringstream& is_file){
@@ -70,8 +74,7 @@ struct MatBias {
     VectorXd b;
 };
 
-static MatBias parse_constraints_and_bias(ifstream& is_file){
-    string line;
+static MatBias parse_constraints_and_bias(ifstream& is_file, string& line){
     vector<VectorXd> vects;
     vector<double> b_vals;
     while (getline(is_file, line)){
@@ -101,20 +104,62 @@ static MatBias parse_constraints_and_bias(ifstream& is_file){
     return {A, b};
 }
 
+static vector<int> parse_var_list(const string& line){
+    // Parses something like " x1 x4 x7"
+    vector<int> indices;
+    istringstream is_line(line);
+    string var;
+    while(is_line >> var){
+        if (var.size() > 1 && var[0] == 'x') {
+            indices.push_back(stoi(var.substr(1)) - 1);
+        }
+    }
+    return indices;
+}
+
+static VectorXi to_vectorxi(const vector<int>& v){
+    VectorXi vect(v.size());
+    for (int i = 0; i < v.size(); ++i) {
+        vect(i) = v[i];
+    }
+    return vect;
+}
+
+enum Section { OTHER, GENERAL, BINARY };
+
 Problem::Problem(const string& filename){
     /* SHOULD BE ABLE TO PARSE save_glpsol() OUTPUT !!! */
     std::ifstream is_file(filename);
     string line;
     VectorXd partial_costs;
-    while(getline(is_file, line)){
-        if(line == "Minimize"){
+    vector<int> generals, binaries;
+    Section section = OTHER;
+    // Set when the line that ended the constraints still has to be handled
+    bool pending_line = false;
+    while(pending_line || getline(is_file, line)){
+        pending_line = false;
+        if(line == "General" || line == "Generals" || line == "Gen"){
+            section = GENERAL;
+        } else if(line == "Binary" || line == "Binaries" || line == "Bin"){
+            section = BINARY;
+        } else if(line == "Minimize"){
             // Parses something like
             // " obj: -12.5162 x1 +40.2776 x2 -53.5679 x3 +84.8146 x4 +79.3232 x5"
             partial_costs = parse_costs(is_file);
         } else if(line == "Subject To"){
-            MatBias mb = parse_constraints_and_bias(is_file);
+            MatBias mb = parse_constraints_and_bias(is_file, line);
             this->A = mb.A;
             this->b = mb.b;
+            pending_line = true;
+        } else if(section == GENERAL || section == BINARY){
+            if (line.find_first_not_of(" \t") != string::npos && line[line.find_first_not_of(" \t")] != 'x') {
+                // Any other section ("Bounds", "End"...) closes the variable list
+                section = OTHER;
+            } else {
+                vector<int> &vars = (section == GENERAL) ? generals : binaries;
+                vector<int> parsed = parse_var_list(line);
+                vars.insert(vars.end(), parsed.begin(), parsed.end());
+            }
         }
     }
     this->costs = VectorXd::Zero(A.cols());
@@ -124,6 +169,63 @@ Problem::Problem(const string& filename){
     for (int i = 0; i < this->A.rows(); ++i) {
         this->basic_vars(i) = A.cols() - A.rows() + i;
     }
+
+    // Binary variables are integer variables too
+    for (int var : binaries) {
+        if (find(generals.begin(), generals.end(), var) == generals.end())
+            generals.push_back(var);
+    }
+    this->integer_vars = to_vectorxi(generals);
+    this->binary_vars = to_vectorxi(binaries);
+    this->density = measure_density(this->A, this->basic_vars);
+}
+
+bool Problem::is_integer() const {
+    return this->integer_vars.size() > 0;
+}
+
+/***
+ * Adds new variables to the problem, one per column of columns.
+ * The current base stays valid, so the simplex can carry on from it.
+ * The new columns are structural ones and are accounted for in the density.
+ */
+void Problem::append_columns(const MatrixXd& columns, const VectorXd& column_costs){
+    long cols = this->A.cols();
+    update_density(columns, 1);
+    this->A.conservativeResize(Eigen::NoChange, cols + columns.cols());
+    this->A.rightCols(columns.cols()) = columns;
+    this->costs.conservativeResize(cols + column_costs.size());
+    this->costs.tail(column_costs.size()) = column_costs;
+}
+
+/***
+ * Removes the given variables from the problem, the remaining ones keep their order.
+ * None of them should be basic, the indices in basic_vars are shifted accordingly.
+ * They should be structural ones, as they are taken out of the density.
+ */
+void Problem::drop_columns(const VectorXi& indices){
+    update_density(LinalgHelper::slice_cols(this->A, indices), -1);
+    VectorXi kept = LinalgHelper::opposite_indices(indices, this->A.cols());
+    VectorXi new_index = VectorXi::Constant(this->A.cols(), -1);
+    for (int i = 0; i < kept.size(); ++i) {
+        new_index(kept(i)) = i;
+    }
+    this->A = LinalgHelper::slice_cols(this->A, kept);
+    this->costs = LinalgHelper::slice_rows(this->costs, kept);
+    for (int i = 0; i < this->basic_vars.size(); ++i) {
+        this->basic_vars(i) = new_index(this->basic_vars(i));
+    }
+}
+
+/***
+ * Adds (sign = 1) or removes (sign = -1) the given structural columns from the density,
+ * the slack columns being the A.rows() ones left out when it was measured.
+ */
+void Problem::update_density(const MatrixXd& columns, int sign){
+    long rows = this->A.rows(), structural_cols = this->A.cols() - rows;
+    double non_zeros = this->density * structural_cols * rows + sign * (columns.array() != 0).count();
+    structural_cols += sign * columns.cols();
+    this->density = (structural_cols > 0 && rows > 0) ? non_zeros / (structural_cols * rows) : 0;
 }
 
 static string get_timestamp(){
@@ -163,7 +265,24 @@ void Problem::save_glpsol(const string& filename){
     for (int k = 0; k < costs.size(); ++k) {
         outStream << " x" << k + 1 << " >= 0";
     }
-    outStream << endl << endl << "End";
+    outStream << endl;
+    if (integer_vars.size() > binary_vars.size()) {
+        outStream << "General" << endl;
+        for (int k = 0; k < integer_vars.size(); ++k) {
+            if ((binary_vars.array() == integer_vars(k)).any())
+                continue;
+            outStream << " x" << integer_vars(k) + 1;
+        }
+        outStream << endl;
+    }
+    if (binary_vars.size() > 0) {
+        outStream << "Binary" << endl;
+        for (int k = 0; k < binary_vars.size(); ++k) {
+            outStream << " x" << binary_vars(k) + 1;
+        }
+        outStream << endl;
+    }
+    outStream << endl << "End";
 }
 
 void Problem::print(){
@@ -171,6 +290,10 @@ void Problem::print(){
     cout << "b\t\t= [" << this->b.transpose() << "]" << endl;
     cout << "costs\t\t= [" << this->costs.transpose() << "]" << endl;
     cout << "basis\t\t= [" << this->basic_vars.transpose() << "]" << endl;
+    cout << "density\t\t= " << this->density << endl;
+    if (this->is_integer()) {
+        cout << "integer\t\t= [" << this->integer_vars.transpose() << "]" << endl;
+    }
 }
 
 void Problem::print_labeled_vect(VectorXd x){
@@ -184,6 +307,26 @@ void Problem::print_labeled_vect(VectorXd x){
     cout << endl;
 }
 
+/***
+ * Share of non zero coefficients among the structural columns of A, i.e. leaving
+ * out the slack columns given in slack_vars, which every problem carries and
+ * which would otherwise dilute the measure.
+ */
+double Problem::measure_density(const MatrixXd& A, const VectorXi& slack_vars){
+    vector<bool> is_slack(A.cols(), false);
+    for (int i = 0; i < slack_vars.size(); ++i) {
+        is_slack[slack_vars(i)] = true;
+    }
+    long non_zeros = 0, structural_cols = 0;
+    for (int j = 0; j < A.cols(); ++j) {
+        if (is_slack[j]) continue;
+        non_zeros += (A.col(j).array() != 0).count();
+        structural_cols++;
+    }
+    if (structural_cols == 0 || A.rows() == 0) return 0;
+    return (double) non_zeros / (structural_cols * A.rows());
+}
+
 Problem* Problem::getRandomProblem(){
     bool round = false;
     // For scaling too small (< 50), GLPSol will indicate that the problem is unsolvable
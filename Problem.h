@@ -33,15 +33,29 @@ public:
     VectorXd b;
     VectorXd costs;
     VectorXi basic_vars;
+    // Indices of the variables restricted to integer values (binary ones included)
+    VectorXi integer_vars;
+    // Indices of the variables restricted to {0, 1}, always a subset of integer_vars
+    VectorXi binary_vars;
+    // Share of non zero coefficients in the structural columns of A when the problem was built
+    double density;
 
     Problem(MatrixXd A, VectorXd b, VectorXd costs, VectorXi basic_vars);
     Problem(const string& filename);
 
+    bool is_integer() const;
+
+    void append_columns(const MatrixXd& columns, const VectorXd& column_costs);
+    void drop_columns(const VectorXi& indices);
+    void update_density(const MatrixXd& columns, int sign);
+
     void print();
     void save_glpsol(const string& filename);
 
     static void print_labeled_vect(VectorXd x);
 
+    static double measure_density(const MatrixXd& A, const VectorXi& slack_vars);
+
     static Problem* getRandomProblem();
 
 };
@@ -14,13 +14,19 @@
  */
 
 #include "Simplex.h"
+#include "DenseBackend.h"
+
+// Basic values above -FEASIBILITY_TOL are considered primal feasible by the dual simplex
+#define FEASIBILITY_TOL 1e-9
+// Coefficients closer to zero than PIVOT_TOL are never pivoted on
+#define PIVOT_TOL 1e-9
 
 namespace Simplex {
     bool is_optimal(const VectorXd &costs, const VectorXi &basic_vars) {
         VectorXi non_basic_vars = opposite_indices(basic_vars, costs.size());
         VectorXd rows = slice_rows(costs, non_basic_vars);
 
-        return rows.minCoeff() >= 0;
+        return rows.size() == 0 || rows.minCoeff() >= 0;
     }
 
     int pivot_col(const VectorXd &costs, const VectorXi &basic_vars) {
@@ -32,10 +38,14 @@ namespace Simplex {
 
     int pivot_row(const MatrixXd &A, const VectorXd &b, int column) {
         VectorXd ratios = b.cwiseQuotient(A.col(column));
-        // Discard any value lower or eq to zero (set it to +infty so that argmin will never get it)
+        // Only rows with a positive coefficient bound the entering variable, discard the others
+        // (set them to +infty so that argmin will never get them). Rounding errors on degenerate
+        // rows can make b slightly negative, which still means a ratio of zero.
         for (int i = 0; i < ratios.size(); ++i) {
-            if (ratios(i) <= 0)
+            if (A(i, column) <= PIVOT_TOL)
                 ratios(i) = numeric_limits<double>::infinity();
+            else if (ratios(i) < 0)
+                ratios(i) = 0;
         }
 
         int row = argmin(ratios);
@@ -46,18 +56,45 @@ namespace Simplex {
         return row;
     }
 
+    int dual_pivot_row(const VectorXd &b) {
+        int row = argmin(b);
+        if (b(row) >= -FEASIBILITY_TOL)
+            return -1;
+        return row;
+    }
+
+    int dual_pivot_col(const MatrixXd &A, const VectorXd &costs, const VectorXi &basic_vars, int row) {
+        VectorXi non_basic_vars = opposite_indices(basic_vars, costs.size());
+        int col = -1;
+        double best_ratio = numeric_limits<double>::infinity();
+        for (int i = 0; i < non_basic_vars.size(); ++i) {
+            int j = non_basic_vars(i);
+            // Only negative coefficients can bring the basic variable of this row back up to zero
+            if (A(row, j) >= -PIVOT_TOL)
+                continue;
+            double ratio = costs(j) / -A(row, j);
+            if (ratio < best_ratio) {
+                best_ratio = ratio;
+                col = j;
+            }
+        }
+        // Nothing can enter the base: this row can never be satisfied
+        if (col == -1) {
+            throw InfeasibleProblemException();
+        }
+        return col;
+    }
+
     MatrixXd get_inverse_base_matrix(const MatrixXd &A, const VectorXi &basic_vars) {
-        MatrixXd B = slice_cols(A, basic_vars);
-        if(abs(B.determinant()) < 1e-4){
-            throw UnboundedProblemException();
+        Eigen::PartialPivLU<MatrixXd> lu(slice_cols(A, basic_vars));
+        if(is_singular(lu)){
+            throw SingularBaseException();
         }
-        return B.inverse();
+        return lu.inverse();
     }
 
     VectorXd get_simplex_mults(const MatrixXd &inverse_base, const VectorXd &costs, const VectorXi &basic_vars) {
         VectorXd trans(basic_vars.size());
-        cout << costs.size() << endl;
-        cout << basic_vars.transpose() << endl;
         for (int i = 0; i < basic_vars.size(); ++i) {
             trans(i) = costs(basic_vars(i));
         }
@@ -118,7 +155,48 @@ namespace Simplex {
 
     }
 
+    double dual_simplex_iteration(Problem *problem, bool verbose) {
+        const MatrixXd &A = problem->A;
+        const VectorXd &b = problem->b;
+        const VectorXd &costs = problem->costs;
+        VectorXi &basic_vars = problem->basic_vars;
+
+        MatrixXd inverse_base = get_inverse_base_matrix(A, basic_vars);
+        VectorXd mults = get_simplex_mults(inverse_base, costs, basic_vars);
+
+        VectorXd new_c = costs - A.transpose() * mults;
+        VectorXd new_b = inverse_base * b;
+        MatrixXd new_A = inverse_base * A;
+        double objective_value = mults.transpose() * b;
+
+        if (verbose) {
+            cout << "B-1  \t= " << endl << inverse_base << endl;
+            cout << "B-1*A\t= " << endl << new_A << endl;
+            cout << "mults\t= [" << mults.transpose() << "]" << endl;
+            cout << "new_c\t= [" << (new_c).transpose() << "]" << endl;
+            cout << "new_b\t= [" << (new_b).transpose() << "]" << endl;
+        }
+
+        // The base stays dual feasible, so it is optimal as soon as it becomes primal feasible
+        int row = dual_pivot_row(new_b);
+        if (row == -1)
+            throw OptimalReachedException(objective_value);
+
+        int col = dual_pivot_col(new_A, new_c, basic_vars, row);
+        // Update base
+        basic_vars(row) = col;
+
+        if (verbose) {
+            cout << "pivot\t= (" << row << ", " << col << ")" << endl;
+            cout << "base  \t= " << basic_vars.transpose() << endl;
+        }
+
+        return objective_value;
+    }
+
     double perform_simplex(Problem *problem, int verbose_level) {
+        if (DenseBackend::uses_dense_backend(problem))
+            return DenseBackend::perform_dense_simplex(problem, verbose_level);
         double objective = numeric_limits<double>::infinity();
         for (int i = 0; i < 1000; ++i) {
             if (verbose_level > 0) cout << "-------------- it #" << i << " --------------" << endl;
@@ -128,4 +206,15 @@ namespace Simplex {
         return objective;
     }
 
+
+    double perform_dual_simplex(Problem *problem, int verbose_level) {
+        double objective = -numeric_limits<double>::infinity();
+        for (int i = 0; i < 1000; ++i) {
+            if (verbose_level > 0) cout << "-------------- dual it #" << i << " --------------" << endl;
+            objective = dual_simplex_iteration(problem, verbose_level >= 2);
+            if (verbose_level > 0) cout << "obj  \t= " << objective << endl;
+        }
+        return objective;
+    }
+
 }
\ No newline at end of file
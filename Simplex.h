@@ -44,6 +44,10 @@ namespace Simplex {
 
     int pivot_row(const MatrixXd& A, const VectorXd& b, int column);
 
+    int dual_pivot_row(const VectorXd& b);
+
+    int dual_pivot_col(const MatrixXd& A, const VectorXd& costs, const VectorXi& basic_vars, int row);
+
     MatrixXd get_inverse_base_matrix(const MatrixXd& A, const VectorXi& basic_vars);
 
     VectorXd get_simplex_mults(const MatrixXd& inverse_base, const VectorXd& costs, const VectorXi& basic_vars);
@@ -54,6 +58,10 @@ namespace Simplex {
 
     double perform_simplex(Problem* problem, int verbose_level);
 
+    double dual_simplex_iteration(Problem* problem, bool verbose);
+
+    double perform_dual_simplex(Problem* problem, int verbose_level);
+
 }
 
 #endif //SIMPLEXCPP_SIMPLEX_H
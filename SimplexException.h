@@ -37,6 +37,24 @@ namespace SimplexException {
             return "Problem is unbounded";
         }
     };
+
+    struct SingularBaseException : public exception {
+        const char * what () noexcept {
+            return "Base matrix is singular";
+        }
+    };
+
+    struct IterationLimitException : public exception {
+        const char * what () noexcept {
+            return "Iteration limit reached before concluding";
+        }
+    };
+
+    struct InfeasibleProblemException : public exception {
+        const char * what () noexcept {
+            return "Problem is infeasible";
+        }
+    };
 }
 
 #endif //SIMPLEXCPP_SIMPLEXEXCEPTION_H
@@ -17,35 +17,76 @@
 #include <cstring>
 #include "Simplex.h"
 #include "Problem.h"
+#include "BranchAndBound.h"
 
 #define DEFAULT_OUTPUT_FILE "out.lp"
 #define FLAG_RANDOM "-R"
 #define FLAG_QUIET "-q"
 #define FLAG_VERBOSE "-v"
 #define FLAG_DOUBLE_VERBOSE "-vv"
+#define FLAG_DEPTH_FIRST "-dfs"
+#define FLAG_THREADS "-j"
 
 using namespace std;
 using namespace Simplex;
 
+static void perform_mip(Problem* problem, BranchAndBound::NodeSelection selection, int thread_count, int verbose_level) {
+    try {
+        BranchAndBound::Result result = BranchAndBound::perform_branch_and_bound(problem, selection, thread_count, verbose_level);
+        if (verbose_level > -1){
+            if (result.dropped_nodes > 0) {
+                cout << "Best integer solution found (" << result.dropped_nodes;
+                cout << " nodes hit the iteration limit, optimality not proven) = ";
+            } else {
+                cout << "Integer optimality reached = ";
+            }
+        }
+        cout << result.objective << endl;
+        if (verbose_level > -1) {
+            cout << (result.dropped_nodes > 0 ? "Best solution = " : "Optimal solution = ") << endl << "\t";
+            Problem::print_labeled_vect(result.solution);
+            cout << result.nodes << " nodes in " << result.seconds << "s (";
+            cout << result.nodes_per_sec() << " nodes/sec)" << endl;
+        } else {
+            cout << result.solution.transpose() << endl;
+        }
+    } catch (InfeasibleProblemException &e) {
+        cerr << e.what() << endl;
+    } catch (IterationLimitException &e) {
+        cerr << e.what() << endl;
+    } catch (UnboundedProblemException &e) {
+        cerr << e.what() << endl;
+    } catch (SingularBaseException &e) {
+        cerr << e.what() << endl;
+    }
+}
+
 int main(int argc, char** argv) {
 
     srand(time(NULL));
     Problem* problem;
 
     int verbose_level = 0;
+    BranchAndBound::NodeSelection selection = BranchAndBound::BEST_BOUND;
+    int thread_count = 0;
     if (argc == 1){
         cout << "Usage: " << argv[0] << " [file.lp or " << FLAG_RANDOM << "] ";
-        cout << "[" << FLAG_QUIET << " or " << FLAG_VERBOSE << " or " << FLAG_DOUBLE_VERBOSE << "]";
+        cout << "[" << FLAG_QUIET << " or " << FLAG_VERBOSE << " or " << FLAG_DOUBLE_VERBOSE << "] ";
+        cout << "[" << FLAG_DEPTH_FIRST << "] [" << FLAG_THREADS << " threads]";
         cout << endl;
         exit(EXIT_SUCCESS);
     }
-    if (argc > 2) {
-        if (strcmp(argv[2], FLAG_QUIET) == 0) {
+    for (int i = 2; i < argc; ++i) {
+        if (strcmp(argv[i], FLAG_QUIET) == 0) {
             verbose_level = -1;
-        } else if (strcmp(argv[2], FLAG_VERBOSE) == 0) {
+        } else if (strcmp(argv[i], FLAG_VERBOSE) == 0) {
             verbose_level = 1;
-        } else if (strcmp(argv[2], FLAG_DOUBLE_VERBOSE) == 0) {
+        } else if (strcmp(argv[i], FLAG_DOUBLE_VERBOSE) == 0) {
             verbose_level = 2;
+        } else if (strcmp(argv[i], FLAG_DEPTH_FIRST) == 0) {
+            selection = BranchAndBound::DEPTH_FIRST;
+        } else if (strcmp(argv[i], FLAG_THREADS) == 0 && i + 1 < argc) {
+            thread_count = atoi(argv[++i]);
         }
     }
     string filename = argv[1];
@@ -60,6 +101,8 @@ int main(int argc, char** argv) {
                 break;
             } catch (UnboundedProblemException&){
                 continue;
+            } catch (SingularBaseException&){
+                continue;
             }
         }
         if (verbose_level > 0){
@@ -73,6 +116,10 @@ int main(int argc, char** argv) {
         problem->print();
         cout << "base sol \t= [" << get_solution_vector(problem).transpose() << "]" << endl;
     }
+    if (problem->is_integer()) {
+        perform_mip(problem, selection, thread_count, verbose_level);
+        return EXIT_SUCCESS;
+    }
     try {
         perform_simplex(problem, verbose_level);
     } catch (OptimalReachedException &e) {
@@ -88,6 +135,8 @@ int main(int argc, char** argv) {
         }
     } catch (UnboundedProblemException &e) {
         cerr << e.what() << endl;
+    } catch (SingularBaseException &e) {
+        cerr << e.what() << endl;
     }
     if (filename == FLAG_RANDOM && verbose_level > -1){
         char type;